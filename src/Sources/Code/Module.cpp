@@ -3,6 +3,10 @@
 #include <SimConnect.h>
 #include <MSFS\Legacy\gauges.h>
 #include <vector>
+#include <unordered_map>
+#include <deque>
+#include <cmath>
+#include <algorithm>
 #include <list>
 #include <string>
 #include <sstream>
@@ -20,11 +24,16 @@ const char* FileEventsUser = "modules/events.user.txt";
 
 std::vector<std::pair<std::string, std::string>> CodeEvents;
 
+// Index into CodeEvents by the FNV-1a hash of the event name, used by the Triggers data area
+std::unordered_map<uint32_t, int> CodeEventHashes;
+
 const char* MOBIFLIGHT_CLIENT_DATA_NAME = "MobiFlight";
 const char* CLIENT_DATA_NAME_POSTFIX_SIMVAR = ".LVars";
 const char* CLIENT_DATA_NAME_POSTFIX_STRINGVAR = ".StringVars";
 const char* CLIENT_DATA_NAME_POSTFIX_COMMAND = ".Command";
 const char* CLIENT_DATA_NAME_POSTFIX_RESPONSE = ".Response";
+const char* CLIENT_DATA_NAME_POSTFIX_WRITEVALUES = ".WriteValues";
+const char* CLIENT_DATA_NAME_POSTFIX_TRIGGERS = ".Triggers";
 
 const int MOBIFLIGHT_MESSAGE_SIZE = 1024;
 
@@ -32,6 +41,19 @@ const int MOBIFLIGHT_MESSAGE_SIZE = 1024;
 // to avoid any conflicts with base IDs
 constexpr uint16_t SIMVAR_OFFSET = 1000;
 
+// Number of client data areas that are created for each client
+constexpr uint16_t CLIENT_DATA_AREA_ID_RANGE = 6;
+
+// Number of fixed data definition ids (Response, Command, WriteValues, Triggers) for each client
+constexpr uint16_t CLIENT_DATA_DEF_ID_FIXED_RANGE = 4;
+
+// Request ids for the WriteValues data areas start here,
+// request ids below are used for the Command data areas
+constexpr DWORD CLIENT_DATA_REQUEST_ID_WRITEVALUES_OFFSET = 1000;
+
+// Request ids for the Triggers data areas start here
+constexpr DWORD CLIENT_DATA_REQUEST_ID_TRIGGERS_OFFSET = 2000;
+
 // For each registered client can 10000 data definition ids are reserved
 constexpr uint16_t CLIENT_DATA_DEF_ID_SIMVAR_RANGE = 10000;
 constexpr uint16_t CLIENT_DATA_DEF_ID_STRINGVAR_RANGE = 10000;
@@ -40,16 +62,73 @@ constexpr uint16_t CLIENT_DATA_DEF_ID_STRINGVAR_RANGE = 10000;
 // Can be set to different value via config command
 uint16_t MOBIFLIGHT_MAX_VARS_PER_FRAME = 30;
 
+// Number of frames between two evaluations of the SimVar group gates, Default: 30
+// Can be set to different value via config command
+uint16_t MOBIFLIGHT_GROUP_GATE_INTERVAL = 30;
+
 // Max length of a string variable. This will affect the maximum amount of string variables
 // due to the maximum client-data-array-size (SIMCONNECT_CLIENTDATA_MAX_SIZE) of 8kB!
 constexpr uint16_t MOBIFLIGHT_STRING_SIMVAR_VALUE_MAX_LEN = 128;
 
+// Number of float slots in the WriteValues data area of each client
+constexpr uint16_t MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS = 256;
+
+// Maximum number of trigger records that can be sent at once via the Triggers data area
+constexpr uint16_t MOBIFLIGHT_TRIGGERS_MAX_RECORDS = 256;
+
+// Maximum window length in seconds of derived Min, Max and Avg SimVars
+constexpr FLOAT64 MOBIFLIGHT_DERIVED_MAX_WINDOW = 60;
+
+// Maximum number of samples kept in the window of a derived SimVar,
+// older samples are dropped first if the source is read very often
+constexpr uint16_t MOBIFLIGHT_DERIVED_MAX_WINDOW_SAMPLES = 4096;
+
+// Flags of a trigger record
+constexpr uint32_t MOBIFLIGHT_TRIGGER_FLAG_HASH = 1;
+constexpr uint32_t MOBIFLIGHT_TRIGGER_FLAG_PARAMETER = 2;
+
+// Parameters of the 32-bit FNV-1a hash
+constexpr uint32_t FNV1A_OFFSET_BASIS = 2166136261u;
+constexpr uint32_t FNV1A_PRIME = 16777619u;
+
+// Kinds of derived SimVars that are computed from the value of another SimVar
+enum class DerivedKind {
+	None,
+	Rate,
+	Ema,
+	Min,
+	Max,
+	Avg
+};
+
+// data struct for the state of a derived SimVar
+struct DerivedState {
+	DerivedKind Kind = DerivedKind::None;
+	// Index of the source SimVar
+	int SourceIndex = -1;
+	// Time constant of Ema or window length of Min, Max and Avg in seconds
+	FLOAT64 Parameter = 0;
+	bool Initialized = false;
+	FLOAT64 LastTime = 0;
+	FLOAT64 LastValue = 0;
+	FLOAT64 WindowSum = 0;
+	// Samples (time, value) of the window for Avg. For Min and Max only the samples
+	// that can still become the result are kept, in monotonic order of their values
+	std::deque<std::pair<FLOAT64, FLOAT64>> Window;
+};
+
 // data struct for dynamically registered SimVars
 struct SimVar {
 	int ID;
 	int Offset;
 	std::string Name;
 	float Value;
+	// Index of the SimVarGroup this SimVar belongs to, -1 if not gated
+	int GroupIndex = -1;
+	// Derived SimVars are not read from the sim but computed from their source SimVar
+	DerivedState Derived;
+	// Indices of the SimVars derived from this SimVar
+	std::vector<int> DerivedIndices;
 };
 
 struct StringSimVar {
@@ -57,6 +136,44 @@ struct StringSimVar {
 	int Offset;
 	std::string Name;
 	std::string Value;
+	// Index of the SimVarGroup this SimVar belongs to, -1 if not gated
+	int GroupIndex = -1;
+};
+
+// data struct for a named group of SimVars that are only read
+// while the gate calculator script evaluates to a non-zero value
+struct SimVarGroup {
+	std::string Name;
+	std::string Gate;
+	bool Active;
+};
+
+// data struct for a float slot in the WriteValues data area,
+// bound to a gauge calculator script that receives the slot value
+struct WriteValue {
+	int Slot;
+	std::string Code;
+	// ID of the LVar if Code is a plain "(>L:Name)" target, otherwise -1
+	ID LVarID;
+	// Last applied value, only valid once Applied is set
+	float Value;
+	// The first value after binding is always applied, even if it equals the buffer content
+	bool Applied;
+};
+
+// data struct for a single record in the Triggers data area
+struct TriggerRecord {
+	// Index into the event definitions or FNV-1a hash of the event name, see Flags
+	uint32_t Preset;
+	uint32_t Flags;
+	// Pushed onto the stack before the event code is executed, if MOBIFLIGHT_TRIGGER_FLAG_PARAMETER is set
+	float Parameter;
+};
+
+// Layout of the Triggers data area
+struct TriggerQueue {
+	uint32_t Count;
+	TriggerRecord Records[MOBIFLIGHT_TRIGGERS_MAX_RECORDS];
 };
 
 // data struct for client accessing SimVars
@@ -67,20 +184,42 @@ struct Client {
 	std::string DataAreaNameResponse;
 	std::string DataAreaNameCommand;
 	std::string DataAreaNameStringVar;
+	std::string DataAreaNameWriteValues;
+	std::string DataAreaNameTriggers;
 	SIMCONNECT_CLIENT_DATA_ID DataAreaIDSimvar;
 	SIMCONNECT_CLIENT_DATA_ID DataAreaIDResponse;
 	SIMCONNECT_CLIENT_DATA_ID DataAreaIDCommand;
 	SIMCONNECT_CLIENT_DATA_ID DataAreaIDStringSimVar;
+	SIMCONNECT_CLIENT_DATA_ID DataAreaIDWriteValues;
+	SIMCONNECT_CLIENT_DATA_ID DataAreaIDTriggers;
 	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIDStringResponse;
 	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIDStringCommand;
+	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIDWriteValues;
+	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIDTriggers;
 	std::vector<SimVar> SimVars;
 	std::vector<StringSimVar> StringSimVars;
+	std::vector<SimVarGroup> SimVarGroups;
+	// Frames since the gates of the SimVarGroups have been evaluated
+	uint16_t GroupGateFrameCounter = 0;
+	uint16_t DerivedSimVarCount = 0;
+	std::vector<WriteValue> WriteValues;
+	// Latest content of the WriteValues data area, applied once per frame
+	std::vector<float> WriteValuesBuffer;
+	bool WriteValuesPending = false;
+	// Set once the client has written the WriteValues data area, so the buffer holds client values
+	bool WriteValuesReceived = false;
+	// Received trigger records, executed once per frame
+	std::vector<TriggerRecord> PendingTriggers;
 
 	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIdSimVarsStart;
 	SIMCONNECT_CLIENT_DATA_DEFINITION_ID DataDefinitionIdStringVarsStart;
 	// This is an optimization to be able to re-use already defined data definition IDs & request IDs
 	// after resetting registered SimVars
 	uint16_t MaxClientDataDefinition = 0;
+	// All received registration commands in order and their hash,
+	// so that reconnecting clients can skip the re-registration
+	std::vector<std::string> Registrations;
+	uint32_t RegistrationHash = FNV1A_OFFSET_BASIS;
 	// Runtime Rolling CLient Data reading Index
 	//std::vector<SimVar>::iterator RollingClientDataReadIndex;
 	uint16_t RollingClientDataReadIndex;
@@ -90,6 +229,9 @@ struct Client {
 // The list of currently registered clients
 std::vector<Client*> RegisteredClients;
 
+// Simulation time of the current frame in seconds, only updated while derived SimVars are registered
+FLOAT64 SimulationTime = 0;
+
 // The list of currently available LVars
 std::vector<std::string> lVarList;
 
@@ -113,6 +255,15 @@ enum eEvents
 
 void CALLBACK MyDispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext);
 
+// Compute the 32-bit FNV-1a hash of a string, continuing from a previous hash value
+uint32_t Fnv1aHash(const std::string& value, uint32_t hash = FNV1A_OFFSET_BASIS) {
+	for (unsigned char c : value) {
+		hash ^= c;
+		hash *= FNV1A_PRIME;
+	}
+	return hash;
+}
+
 // Helper method to split up the lines from config file
 // into Pairs
 std::pair<std::string, std::string> splitIntoPair(std::string value, char delimiter) {
@@ -194,6 +345,16 @@ void LoadEventDefinitions() {
 	int eventDefinition = CodeEvents.size();
 	LoadEventDefinitions(FileEventsUser);
 
+	// The first definition wins if event names are defined twice
+	CodeEventHashes.clear();
+	for (int i = 0; i < CodeEvents.size(); ++i) {
+		auto codeEventHash = CodeEventHashes.emplace(Fnv1aHash(CodeEvents[i].first), i);
+		if (!codeEventHash.second && CodeEvents[codeEventHash.first->second].first != CodeEvents[i].first) {
+			fprintf(stderr, "MobiFlight: Event %s has the same hash %u as event %s and can't be triggered by hash\n",
+				CodeEvents[i].first.c_str(), codeEventHash.first->first, CodeEvents[codeEventHash.first->second].first.c_str());
+		}
+	}
+
 	std::cout << "MobiFlight: Loaded " << CodeEvents.size() << " event definitions in total." << std::endl;
 	std::cout << "MobiFlight: Loaded " << eventDefinition << " built-in event definitions." << std::endl;
 	std::cout << "MobiFlight: Loaded " << CodeEvents.size() - eventDefinition << " user event definitions." << std::endl;
@@ -284,8 +445,13 @@ void WriteSimVar(SimVar& simVar, Client* client) {
 #endif
 }
 
-// Register a single Float-SimVar and send the current value to SimConnect Clients
-void RegisterFloatSimVar(const std::string code, Client* client) {
+// Check if a SimVar is read, which is the case if it has no group or its group gate is open
+bool IsSimVarGroupActive(int groupIndex, Client* client) {
+	return groupIndex < 0 || client->SimVarGroups[groupIndex].Active;
+}
+
+// Add a single Float-SimVar and its client data definition, returns the index of the new SimVar
+int AddFloatSimVar(const std::string code, Client* client, int groupIndex) {
 	std::vector<SimVar>* SimVars = &(client->SimVars);
 	std::vector<StringSimVar>* StringSimVars = &(client->StringSimVars);
 	SimVar newSimVar;
@@ -295,6 +461,7 @@ void RegisterFloatSimVar(const std::string code, Client* client) {
 	newSimVar.ID = SimVars->size() + client->DataDefinitionIdSimVarsStart;
 	newSimVar.Offset = SimVars->size() * (sizeof(float));
 	newSimVar.Value = 0.0F;
+	newSimVar.GroupIndex = groupIndex;
 	SimVars->push_back(newSimVar);
 
 	if (client->MaxClientDataDefinition < (SimVars->size() + StringSimVars->size())) {
@@ -319,6 +486,16 @@ void RegisterFloatSimVar(const std::string code, Client* client) {
 		client->MaxClientDataDefinition = (SimVars->size() + StringSimVars->size());
 	}
 
+	return SimVars->size() - 1;
+}
+
+// Register a single Float-SimVar and send the current value to SimConnect Clients
+void RegisterFloatSimVar(const std::string code, Client* client, int groupIndex = -1) {
+	SimVar newSimVar = client->SimVars[AddFloatSimVar(code, client, groupIndex)];
+
+	// SimVars of a closed group are read as soon as the gate opens
+	if (!IsSimVarGroupActive(groupIndex, client)) return;
+
 	FLOAT64 floatVal = 0;
 	execute_calculator_code(std::string(code).c_str(), &floatVal, nullptr, nullptr);
 	newSimVar.Value = floatVal;
@@ -330,7 +507,7 @@ void RegisterFloatSimVar(const std::string code, Client* client) {
 }
 
 // Register a single String-SimVar and send the current value to SimConnect Clients
-void RegisterStringSimVar(const std::string code, Client* client) {
+void RegisterStringSimVar(const std::string code, Client* client, int groupIndex = -1) {
 	std::vector<SimVar>* SimVars = &(client->SimVars);
 	std::vector<StringSimVar>* StringSimVars = &(client->StringSimVars);
 	StringSimVar newStringSimVar;
@@ -340,6 +517,7 @@ void RegisterStringSimVar(const std::string code, Client* client) {
 	newStringSimVar.ID = StringSimVars->size() + client->DataDefinitionIdStringVarsStart;
 	newStringSimVar.Offset = StringSimVars->size() * MOBIFLIGHT_STRING_SIMVAR_VALUE_MAX_LEN;
 	newStringSimVar.Value.empty();
+	newStringSimVar.GroupIndex = groupIndex;
 	StringSimVars->push_back(newStringSimVar);
 
 	if (client->MaxClientDataDefinition < (SimVars->size() + StringSimVars->size())) {
@@ -364,6 +542,9 @@ void RegisterStringSimVar(const std::string code, Client* client) {
 		client->MaxClientDataDefinition = (SimVars->size() + StringSimVars->size());
 	}
 
+	// SimVars of a closed group are read as soon as the gate opens
+	if (!IsSimVarGroupActive(groupIndex, client)) return;
+
 	PCSTRINGZ charVal = nullptr;
 	execute_calculator_code(std::string(code).c_str(), nullptr, nullptr, &charVal);
 	newStringSimVar.Value = std::string(charVal, strnlen(charVal, MOBIFLIGHT_STRING_SIMVAR_VALUE_MAX_LEN));
@@ -391,18 +572,158 @@ void ClearSimVars(Client* client) {
 		WriteSimVar(simVar, client);
 	}
 	client->StringSimVars.clear();
+	client->SimVarGroups.clear();
+	client->DerivedSimVarCount = 0;
+	client->Registrations.clear();
+	client->RegistrationHash = FNV1A_OFFSET_BASIS;
 
 	std::cout << "MobiFlight[" << client->Name.c_str() << "]: Cleared SimVar tracking." << std::endl;
 	//client->RollingClientDataReadIndex = client->SimVars.begin();
 	client->RollingClientDataReadIndex = 0;
 }
 
+// Register a derived Float-SimVar, the command has the format "SourceIndex.Kind[.Parameter]"
+// e.g. "0.Rate", "0.Ema.2.5" or "0.Max.10"
+void RegisterDerivedSimVar(const std::string command, Client* client) {
+	auto index = command.find('.');
+	if (index == std::string::npos) {
+		fprintf(stderr, "MobiFlight[%s]: Invalid derived SimVar \"%s\"\n", client->Name.c_str(), command.c_str());
+		return;
+	}
+
+	std::string sourceText = command.substr(0, index);
+	char* end = nullptr;
+	long sourceIndex = strtol(sourceText.c_str(), &end, 10);
+	if (sourceText.empty() || *end != '\0' || sourceIndex < 0 || sourceIndex >= client->SimVars.size()
+		|| client->SimVars[sourceIndex].Derived.Kind != DerivedKind::None) {
+		fprintf(stderr, "MobiFlight[%s]: Invalid source SimVar \"%s\" for derived SimVar\n", client->Name.c_str(), sourceText.c_str());
+		return;
+	}
+
+	std::string kind = command.substr(index + 1);
+	std::string parameter;
+	index = kind.find('.');
+	if (index != std::string::npos) {
+		parameter = kind.substr(index + 1);
+		kind = kind.substr(0, index);
+	}
+
+	DerivedState derived;
+	derived.SourceIndex = sourceIndex;
+	if (kind == "Rate") derived.Kind = DerivedKind::Rate;
+	else if (kind == "Ema") derived.Kind = DerivedKind::Ema;
+	else if (kind == "Min") derived.Kind = DerivedKind::Min;
+	else if (kind == "Max") derived.Kind = DerivedKind::Max;
+	else if (kind == "Avg") derived.Kind = DerivedKind::Avg;
+
+	if (derived.Kind == DerivedKind::None || (derived.Kind != DerivedKind::Rate && parameter.empty())) {
+		fprintf(stderr, "MobiFlight[%s]: Invalid derived SimVar \"%s\"\n", client->Name.c_str(), command.c_str());
+		return;
+	}
+	if (!parameter.empty()) {
+		derived.Parameter = strtod(parameter.c_str(), &end);
+		// Ema accepts a time constant of 0, the windows of Min, Max and Avg must not be empty
+		// and are limited to keep the memory of the samples bounded
+		bool isWindow = derived.Kind == DerivedKind::Min || derived.Kind == DerivedKind::Max || derived.Kind == DerivedKind::Avg;
+		if (*end != '\0' || !std::isfinite(derived.Parameter) || derived.Parameter < 0
+			|| (isWindow && (derived.Parameter == 0 || derived.Parameter > MOBIFLIGHT_DERIVED_MAX_WINDOW))) {
+			fprintf(stderr, "MobiFlight[%s]: Invalid parameter \"%s\" for derived SimVar\n", client->Name.c_str(), parameter.c_str());
+			return;
+		}
+	}
+
+	int derivedIndex = AddFloatSimVar(command, client, client->SimVars[sourceIndex].GroupIndex);
+	client->SimVars[derivedIndex].Derived = derived;
+	client->SimVars[sourceIndex].DerivedIndices.push_back(derivedIndex);
+	client->DerivedSimVarCount++;
+}
+
+// Compute a derived SimVar from the current value of its source
+// and send the result to SimConnect Clients if it has changed
+void UpdateDerivedSimVar(SimVar& simVar, FLOAT64 sourceValue, Client* client) {
+	DerivedState& derived = simVar.Derived;
+	FLOAT64 result = 0;
+
+	// The simulation time has been reset, e.g. a new flight has been loaded
+	if (derived.Initialized && SimulationTime < derived.LastTime) {
+		derived.Initialized = false;
+		derived.Window.clear();
+	}
+
+	if (!derived.Initialized) {
+		derived.Initialized = true;
+		derived.LastValue = sourceValue;
+		derived.LastTime = SimulationTime;
+		result = (derived.Kind == DerivedKind::Rate) ? 0 : sourceValue;
+		if (derived.Kind == DerivedKind::Min || derived.Kind == DerivedKind::Max || derived.Kind == DerivedKind::Avg) {
+			derived.Window.push_back(std::make_pair(SimulationTime, sourceValue));
+			derived.WindowSum = (derived.Kind == DerivedKind::Avg) ? sourceValue : 0;
+		}
+	}
+	else {
+		// No time has passed, e.g. the sim is paused or the source was read twice in this frame
+		FLOAT64 deltaTime = SimulationTime - derived.LastTime;
+		if (deltaTime <= 0) return;
+
+		switch (derived.Kind) {
+			case DerivedKind::Rate:
+				result = (sourceValue - derived.LastValue) / deltaTime;
+				break;
+
+			case DerivedKind::Ema: {
+				FLOAT64 alpha = (derived.Parameter > 0) ? 1 - std::exp(-deltaTime / derived.Parameter) : 1;
+				result = simVar.Value + alpha * (sourceValue - simVar.Value);
+				break;
+			}
+
+			case DerivedKind::Avg: {
+				derived.Window.push_back(std::make_pair(SimulationTime, sourceValue));
+				derived.WindowSum += sourceValue;
+				while (!derived.Window.empty() && (derived.Window.front().first < SimulationTime - derived.Parameter
+					|| derived.Window.size() > MOBIFLIGHT_DERIVED_MAX_WINDOW_SAMPLES)) {
+					derived.WindowSum -= derived.Window.front().second;
+					derived.Window.pop_front();
+				}
+				result = derived.Window.empty() ? sourceValue : derived.WindowSum / derived.Window.size();
+				break;
+			}
+
+			default: {
+				// Samples that are older and not better than the new one can never become the result
+				bool isMin = (derived.Kind == DerivedKind::Min);
+				while (!derived.Window.empty() && (isMin ? derived.Window.back().second >= sourceValue : derived.Window.back().second <= sourceValue)) {
+					derived.Window.pop_back();
+				}
+				derived.Window.push_back(std::make_pair(SimulationTime, sourceValue));
+				while (!derived.Window.empty() && (derived.Window.front().first < SimulationTime - derived.Parameter
+					|| derived.Window.size() > MOBIFLIGHT_DERIVED_MAX_WINDOW_SAMPLES)) {
+					derived.Window.pop_front();
+				}
+				result = derived.Window.empty() ? sourceValue : derived.Window.front().second;
+				break;
+			}
+		}
+
+		derived.LastValue = sourceValue;
+		derived.LastTime = SimulationTime;
+	}
+
+	if (simVar.Value == (float)result) return;
+	simVar.Value = result;
+
+	WriteSimVar(simVar, client);
+}
+
 // Read a single SimVar and send the current value to SimConnect Clients (overloaded for float SimVars)
 void ReadSimVar(SimVar &simVar, Client* client) {
 	FLOAT64 floatVal = 0;
 
 	execute_calculator_code(std::string(simVar.Name).c_str(), &floatVal, nullptr, nullptr);
 
+	for (int derivedIndex : simVar.DerivedIndices) {
+		UpdateDerivedSimVar(client->SimVars[derivedIndex], floatVal, client);
+	}
+
 	if (simVar.Value == floatVal) return;
 	simVar.Value = floatVal;
 
@@ -431,21 +752,142 @@ void ReadSimVar(StringSimVar &simVar, Client* client) {
 #endif
 }
 
-// Read all dynamically registered SimVars
+// Evaluate the gate of a SimVarGroup and read all of its SimVars
+// immediately when the gate has been opened
+void UpdateSimVarGroup(int groupIndex, Client* client) {
+	SimVarGroup& group = client->SimVarGroups[groupIndex];
+	FLOAT64 floatVal = 0;
+
+	execute_calculator_code(group.Gate.c_str(), &floatVal, nullptr, nullptr);
+	bool active = (floatVal != 0);
+	if (group.Active == active) return;
+	group.Active = active;
+
+#if _DEBUG
+	std::cout << "MobiFlight[" << client->Name.c_str() << "]: SimVarGroup " << group.Name.c_str();
+	std::cout << " is " << (active ? "active" : "inactive") << std::endl;
+#endif
+
+	if (!active) return;
+
+	for (auto& simVar : client->SimVars) {
+		if (simVar.GroupIndex == groupIndex && simVar.Derived.Kind == DerivedKind::None) ReadSimVar(simVar, client);
+	}
+	for (auto& simVar : client->StringSimVars) {
+		if (simVar.GroupIndex == groupIndex) ReadSimVar(simVar, client);
+	}
+}
+
+// Register a named SimVarGroup with its gate calculator script,
+// an already existing group with the same name gets the new gate
+void RegisterSimVarGroup(const std::string command, Client* client) {
+	auto index = command.find('.');
+	if (index == std::string::npos) {
+		fprintf(stderr, "MobiFlight[%s]: Invalid SimVarGroup \"%s\"\n", client->Name.c_str(), command.c_str());
+		return;
+	}
+
+	std::string name = command.substr(0, index);
+	auto& groups = client->SimVarGroups;
+	auto existing = std::find_if(groups.begin(), groups.end(), [&name](const SimVarGroup& group) { return group.Name == name; });
+	if (existing == groups.end()) {
+		groups.push_back(SimVarGroup{ name, "", false });
+		existing = groups.end() - 1;
+	}
+	existing->Gate = command.substr(index + 1);
+
+	UpdateSimVarGroup(existing - groups.begin(), client);
+}
+
+// Register a single Float- or String-SimVar as member of a SimVarGroup,
+// the command has the format "GroupName.code"
+void RegisterGroupSimVar(const std::string command, Client* client, bool isString) {
+	auto index = command.find('.');
+	std::string name = command.substr(0, index);
+	auto& groups = client->SimVarGroups;
+	auto group = std::find_if(groups.begin(), groups.end(), [&name](const SimVarGroup& group) { return group.Name == name; });
+	if (index == std::string::npos || group == groups.end()) {
+		fprintf(stderr, "MobiFlight[%s]: Unknown SimVarGroup for \"%s\"\n", client->Name.c_str(), command.c_str());
+		return;
+	}
+
+	std::string code = command.substr(index + 1);
+	if (isString) {
+		RegisterStringSimVar(code, client, group - groups.begin());
+	}
+	else {
+		RegisterFloatSimVar(code, client, group - groups.begin());
+	}
+}
+
+// Evaluate the gates of all SimVarGroups of a client every MOBIFLIGHT_GROUP_GATE_INTERVAL frames
+void UpdateSimVarGroups(Client* client) {
+	if (client->SimVarGroups.empty()) return;
+	if (++client->GroupGateFrameCounter < MOBIFLIGHT_GROUP_GATE_INTERVAL) return;
+	client->GroupGateFrameCounter = 0;
+
+	for (int i = 0; i < client->SimVarGroups.size(); ++i) {
+		UpdateSimVarGroup(i, client);
+	}
+}
+
+// Add a registration command to the manifest of a client,
+// each command is hashed including a terminating line feed
+void AddRegistration(const std::string& command, Client* client) {
+	client->Registrations.push_back(command);
+	client->RegistrationHash = Fnv1aHash(command, client->RegistrationHash);
+	client->RegistrationHash = Fnv1aHash("\n", client->RegistrationHash);
+}
+
+// Send the number of registration commands and their hash to the client
+// and write all current values again, so that a client which skips the
+// re-registration receives the complete LVars and StringVars data areas
+void SendManifest(Client* client) {
+	std::string manifest = "MF.SimVars.Manifest." + std::to_string(client->Registrations.size()) + "." + std::to_string(client->RegistrationHash);
+	SendResponse(manifest.c_str(), client);
+
+	for (auto& simVar : client->SimVars) {
+		WriteSimVar(simVar, client);
+	}
+	for (auto& simVar : client->StringSimVars) {
+		WriteSimVar(simVar, client);
+	}
+
+	std::cout << "MobiFlight[" << client->Name.c_str() << "]: Sent manifest > " << manifest.c_str() << std::endl;
+}
+
+// Read all dynamically registered SimVars,
+// SimVars of inactive groups and derived SimVars are skipped and don't count against MOBIFLIGHT_MAX_VARS_PER_FRAME
 void ReadSimVars() {
+	bool hasDerivedSimVars = std::any_of(RegisteredClients.begin(), RegisteredClients.end(), [](Client* client) { return client->DerivedSimVarCount > 0; });
+	if (hasDerivedSimVars) {
+		execute_calculator_code("(E:SIMULATION TIME,second)", &SimulationTime, nullptr, nullptr);
+	}
+
 	for (auto& client : RegisteredClients) {
 		std::vector<SimVar>* SimVars = &(client->SimVars);
 		std::vector<StringSimVar>* StringSimVars = &(client->StringSimVars);
 
+		UpdateSimVarGroups(client);
+
 		int totalSimVars = SimVars->size() + StringSimVars->size();
 		int maxVarsPerFrame = (totalSimVars < MOBIFLIGHT_MAX_VARS_PER_FRAME) ? totalSimVars : MOBIFLIGHT_MAX_VARS_PER_FRAME;
+		int readVars = 0;
 
-		for (int i=0; i < maxVarsPerFrame; ++i) {
+		for (int i=0; i < totalSimVars && readVars < maxVarsPerFrame; ++i) {
 			if(client->RollingClientDataReadIndex < SimVars->size() ) {
-				ReadSimVar(SimVars->at(client->RollingClientDataReadIndex), client);
+				SimVar& simVar = SimVars->at(client->RollingClientDataReadIndex);
+				if (simVar.Derived.Kind == DerivedKind::None && IsSimVarGroupActive(simVar.GroupIndex, client)) {
+					ReadSimVar(simVar, client);
+					readVars++;
+				}
 			}
 			else {
-				ReadSimVar(StringSimVars->at(client->RollingClientDataReadIndex - SimVars->size()), client);
+				StringSimVar& simVar = StringSimVars->at(client->RollingClientDataReadIndex - SimVars->size());
+				if (IsSimVarGroupActive(simVar.GroupIndex, client)) {
+					ReadSimVar(simVar, client);
+					readVars++;
+				}
 			}
 			client->RollingClientDataReadIndex++;
 			if (client->RollingClientDataReadIndex >= totalSimVars)
@@ -454,10 +896,156 @@ void ReadSimVars() {
 	}
 }
 
+// Format a float value for a gauge calculator script without losing precision
+std::string FormatFloat(float value) {
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%.9g", value);
+	return std::string(buffer);
+}
+
+// Bind a float slot of the WriteValues data area to a gauge calculator script.
+// The slot value is pushed onto the stack before the script is executed,
+// e.g. "(>L:XMLVAR_Throttle)" sets the LVar to the slot value.
+void BindWriteValue(const std::string command, Client* client) {
+	auto index = command.find('.');
+	if (index == std::string::npos) {
+		fprintf(stderr, "MobiFlight[%s]: Invalid WriteValues binding \"%s\"\n", client->Name.c_str(), command.c_str());
+		return;
+	}
+
+	std::string slotText = command.substr(0, index);
+	char* end = nullptr;
+	long slot = strtol(slotText.c_str(), &end, 10);
+	if (slotText.empty() || *end != '\0') {
+		fprintf(stderr, "MobiFlight[%s]: Invalid WriteValues slot \"%s\"\n", client->Name.c_str(), slotText.c_str());
+		return;
+	}
+	if (slot < 0 || slot >= MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS) {
+		fprintf(stderr, "MobiFlight[%s]: WriteValues slot %ld out of range\n", client->Name.c_str(), slot);
+		return;
+	}
+
+	WriteValue newWriteValue;
+	newWriteValue.Slot = slot;
+	newWriteValue.Code = command.substr(index + 1);
+	newWriteValue.LVarID = -1;
+	newWriteValue.Value = 0.0F;
+	newWriteValue.Applied = false;
+	// A slot the client has already written gets its current value applied with the next frame,
+	// otherwise the first value written after binding is applied
+	if (client->WriteValuesReceived) client->WriteValuesPending = true;
+
+	// Plain LVar targets are set directly without parsing the script on every write
+	const std::string lVarPrefix = "(>L:";
+	const std::string& code = newWriteValue.Code;
+	if (code.compare(0, lVarPrefix.length(), lVarPrefix) == 0 && code.back() == ')'
+		&& code.find_first_of(",)", lVarPrefix.length()) == code.length() - 1) {
+		std::string lVarName = code.substr(lVarPrefix.length(), code.length() - lVarPrefix.length() - 1);
+		newWriteValue.LVarID = register_named_variable(lVarName.c_str());
+	}
+
+	auto& writeValues = client->WriteValues;
+	auto existing = std::find_if(writeValues.begin(), writeValues.end(), [slot](const WriteValue& writeValue) { return writeValue.Slot == slot; });
+	if (existing != writeValues.end()) {
+		*existing = newWriteValue;
+	}
+	else {
+		writeValues.push_back(newWriteValue);
+	}
+
+#if _DEBUG
+	std::cout << "MobiFlight[" << client->Name.c_str() << "]: Bound WriteValue slot " << slot;
+	std::cout << " to " << newWriteValue.Code.c_str() << " (LVarID: " << newWriteValue.LVarID << ")" << std::endl;
+#endif
+}
+
+// Clear all bindings of the WriteValues data area
+void ClearWriteValues(Client* client) {
+	client->WriteValues.clear();
+	std::cout << "MobiFlight[" << client->Name.c_str() << "]: Cleared WriteValues bindings." << std::endl;
+}
+
+// Store the latest content of the WriteValues data area,
+// the values are applied with the next frame
+void ReceiveWriteValues(const SIMCONNECT_RECV_CLIENT_DATA* recv_data, Client* client) {
+	memcpy(client->WriteValuesBuffer.data(), &recv_data->dwData, MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS * sizeof(float));
+	client->WriteValuesPending = true;
+	client->WriteValuesReceived = true;
+}
+
+// Apply all changed slots of the WriteValues data areas,
+// only the latest value per slot is executed
+void ApplyWriteValues() {
+	for (auto& client : RegisteredClients) {
+		if (!client->WriteValuesPending) continue;
+		client->WriteValuesPending = false;
+
+		for (auto& writeValue : client->WriteValues) {
+			float value = client->WriteValuesBuffer[writeValue.Slot];
+			if (writeValue.Applied && writeValue.Value == value) continue;
+			writeValue.Value = value;
+			writeValue.Applied = true;
+
+			if (writeValue.LVarID >= 0) {
+				set_named_variable_value(writeValue.LVarID, value);
+			}
+			else {
+				std::string code = FormatFloat(value) + " " + writeValue.Code;
+				execute_calculator_code(code.c_str(), nullptr, nullptr, nullptr);
+			}
+#if _DEBUG
+			std::cout << "MobiFlight[" << client->Name.c_str() << "]: Applied WriteValue slot " << writeValue.Slot;
+			std::cout << " with value " << value << " to " << writeValue.Code.c_str() << std::endl;
+#endif
+		}
+	}
+}
+
+// Queue all trigger records of the Triggers data area,
+// the triggers are executed with the next frame
+void ReceiveTriggers(const SIMCONNECT_RECV_CLIENT_DATA* recv_data, Client* client) {
+	const TriggerQueue* queue = reinterpret_cast<const TriggerQueue*>(&recv_data->dwData);
+	uint32_t count = (queue->Count < MOBIFLIGHT_TRIGGERS_MAX_RECORDS) ? queue->Count : MOBIFLIGHT_TRIGGERS_MAX_RECORDS;
+	client->PendingTriggers.insert(client->PendingTriggers.end(), queue->Records, queue->Records + count);
+}
+
+// Execute all queued trigger records of all clients
+void ExecuteTriggers() {
+	for (auto& client : RegisteredClients) {
+		for (const auto& trigger : client->PendingTriggers) {
+			int codeEventId = -1;
+			if (trigger.Flags & MOBIFLIGHT_TRIGGER_FLAG_HASH) {
+				auto codeEventHash = CodeEventHashes.find(trigger.Preset);
+				if (codeEventHash != CodeEventHashes.end()) codeEventId = codeEventHash->second;
+			}
+			else if (trigger.Preset < CodeEvents.size()) {
+				codeEventId = trigger.Preset;
+			}
+
+			if (codeEventId < 0) {
+				fprintf(stderr, "MobiFlight[%s]: Unknown trigger preset %u (Flags: %u)\n", client->Name.c_str(), trigger.Preset, trigger.Flags);
+				continue;
+			}
+
+			std::string command = CodeEvents[codeEventId].second;
+			if (trigger.Flags & MOBIFLIGHT_TRIGGER_FLAG_PARAMETER) {
+				command = FormatFloat(trigger.Parameter) + " " + command;
+			}
+#if _DEBUG
+			std::cout << "MobiFlight[" << client->Name.c_str() << "]: Trigger execute " << command.c_str() << std::endl;
+#endif
+			execute_calculator_code(command.c_str(), nullptr, nullptr, nullptr);
+		}
+		client->PendingTriggers.clear();
+	}
+}
+
 // Basic initialization of all required data areas
 // "ClientName.LVars" -> All LVars are updated here, and all variables are floats
 // "ClientName.Response" -> All responses are provided back to clients, the data is string with max length 255
 // "ClientName.Command" -> SimConnect clients can send Commands via this data area
+// "ClientName.WriteValues" -> SimConnect clients can write float values to bound slots via this data area
+// "ClientName.Triggers" -> SimConnect clients can trigger event definitions by index or name hash via this data area
 void RegisterClientDataArea(Client* client) {
 	HRESULT hr = SimConnect_MapClientDataNameToID(g_hSimConnect, client->DataAreaNameSimVar.c_str(), client->DataAreaIDSimvar);
 	if (hr != S_OK) {
@@ -487,6 +1075,20 @@ void RegisterClientDataArea(Client* client) {
 	}
 	SimConnect_CreateClientData(g_hSimConnect, client->DataAreaIDStringSimVar, SIMCONNECT_CLIENTDATA_MAX_SIZE, SIMCONNECT_CREATE_CLIENT_DATA_FLAG_DEFAULT);
 
+	hr = SimConnect_MapClientDataNameToID(g_hSimConnect, client->DataAreaNameWriteValues.c_str(), client->DataAreaIDWriteValues);
+	if (hr != S_OK) {
+		fprintf(stderr, "MobiFlight: Error on creating Client Data Area. %lu", hr);
+		return;
+	}
+	SimConnect_CreateClientData(g_hSimConnect, client->DataAreaIDWriteValues, MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS * sizeof(float), SIMCONNECT_CREATE_CLIENT_DATA_FLAG_DEFAULT);
+
+	hr = SimConnect_MapClientDataNameToID(g_hSimConnect, client->DataAreaNameTriggers.c_str(), client->DataAreaIDTriggers);
+	if (hr != S_OK) {
+		fprintf(stderr, "MobiFlight: Error on creating Client Data Area. %lu", hr);
+		return;
+	}
+	SimConnect_CreateClientData(g_hSimConnect, client->DataAreaIDTriggers, sizeof(TriggerQueue), SIMCONNECT_CREATE_CLIENT_DATA_FLAG_DEFAULT);
+
 	DWORD dataAreaOffset = 0;
 	hr = SimConnect_AddToClientDataDefinition(
 		g_hSimConnect,
@@ -513,6 +1115,43 @@ void RegisterClientDataArea(Client* client) {
 		0,
 		0,
 		0);
+
+	hr = SimConnect_AddToClientDataDefinition(
+		g_hSimConnect,
+		client->DataDefinitionIDWriteValues,
+		dataAreaOffset,
+		MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS * sizeof(float),
+		0
+	);
+
+	SimConnect_RequestClientData(g_hSimConnect,
+		client->DataAreaIDWriteValues,
+		CLIENT_DATA_REQUEST_ID_WRITEVALUES_OFFSET + client->ID, //RequestID
+		client->DataDefinitionIDWriteValues,
+		SIMCONNECT_CLIENT_DATA_PERIOD_ON_SET,
+		SIMCONNECT_CLIENT_DATA_REQUEST_FLAG_DEFAULT, // Identical writes have to be received for new bindings
+		0,
+		0,
+		0);
+
+	hr = SimConnect_AddToClientDataDefinition(
+		g_hSimConnect,
+		client->DataDefinitionIDTriggers,
+		dataAreaOffset,
+		sizeof(TriggerQueue),
+		0
+	);
+
+	// Every set is received, sending the same triggers again has to execute them again
+	SimConnect_RequestClientData(g_hSimConnect,
+		client->DataAreaIDTriggers,
+		CLIENT_DATA_REQUEST_ID_TRIGGERS_OFFSET + client->ID, //RequestID
+		client->DataDefinitionIDTriggers,
+		SIMCONNECT_CLIENT_DATA_PERIOD_ON_SET,
+		SIMCONNECT_CLIENT_DATA_REQUEST_FLAG_DEFAULT,
+		0,
+		0,
+		0);
 }
 
 // Register new client and initialize data areas if necessary
@@ -532,18 +1171,27 @@ Client* RegisterNewClient(const std::string clientName) {
 		newClient = new Client();
 		newClient->Name = clientName;
 		newClient->ID = RegisteredClients.size();
-		newClient->DataAreaIDSimvar = 4 * newClient->ID;
+		newClient->DataAreaIDSimvar = CLIENT_DATA_AREA_ID_RANGE * newClient->ID;
 		newClient->DataAreaIDCommand = newClient->DataAreaIDSimvar + 1;
 		newClient->DataAreaIDResponse = newClient->DataAreaIDCommand + 1;
 		newClient->DataAreaIDStringSimVar = newClient->DataAreaIDResponse + 1;
+		newClient->DataAreaIDWriteValues = newClient->DataAreaIDStringSimVar + 1;
+		newClient->DataAreaIDTriggers = newClient->DataAreaIDWriteValues + 1;
 		newClient->DataAreaNameSimVar = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_SIMVAR);
 		newClient->DataAreaNameResponse = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_RESPONSE);
 		newClient->DataAreaNameCommand = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_COMMAND);
 		newClient->DataAreaNameStringVar = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_STRINGVAR);
-		newClient->DataDefinitionIDStringResponse = 2 * newClient->ID; // 500 Clients possible until offset 1000 is reached
+		newClient->DataAreaNameWriteValues = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_WRITEVALUES);
+		newClient->DataAreaNameTriggers = newClient->Name + std::string(CLIENT_DATA_NAME_POSTFIX_TRIGGERS);
+		newClient->DataDefinitionIDStringResponse = CLIENT_DATA_DEF_ID_FIXED_RANGE * newClient->ID; // 250 Clients possible until offset 1000 is reached
 		newClient->DataDefinitionIDStringCommand = newClient->DataDefinitionIDStringResponse + 1;
+		newClient->DataDefinitionIDWriteValues = newClient->DataDefinitionIDStringCommand + 1;
+		newClient->DataDefinitionIDTriggers = newClient->DataDefinitionIDWriteValues + 1;
 		newClient->SimVars = std::vector<SimVar>();
 		newClient->StringSimVars = std::vector<StringSimVar>();
+		newClient->WriteValues = std::vector<WriteValue>();
+		newClient->WriteValuesBuffer = std::vector<float>(MOBIFLIGHT_WRITE_VALUES_MAX_SLOTS, 0.0F);
+		newClient->PendingTriggers = std::vector<TriggerRecord>();
 		//newClient->RollingClientDataReadIndex = newClient->SimVars.begin();
 		newClient->RollingClientDataReadIndex = 0;
 		newClient->DataDefinitionIdSimVarsStart = SIMVAR_OFFSET + (newClient->ID * (CLIENT_DATA_DEF_ID_SIMVAR_RANGE + CLIENT_DATA_DEF_ID_STRINGVAR_RANGE));
@@ -565,9 +1213,15 @@ Client* RegisterNewClient(const std::string clientName) {
 		std::cout << "MobiFlight: NewClient DataAreaNameSimVar: " << newClient->DataAreaNameSimVar.c_str() << std::endl;
 		std::cout << "MobiFlight: NewClient DataAreaNameResponse: " << newClient->DataAreaNameResponse.c_str() << std::endl;
 		std::cout << "MobiFlight: NewClient DataAreaNameCommand: " << newClient->DataAreaNameCommand.c_str() << std::endl;
+		std::cout << "MobiFlight: NewClient DataAreaIDWriteValues: " << newClient->DataAreaIDWriteValues << std::endl;
+		std::cout << "MobiFlight: NewClient DataAreaIDTriggers: " << newClient->DataAreaIDTriggers << std::endl;
 		std::cout << "MobiFlight: NewClient DataAreaNameStringVar: " << newClient->DataAreaNameStringVar.c_str() << std::endl;
+		std::cout << "MobiFlight: NewClient DataAreaNameWriteValues: " << newClient->DataAreaNameWriteValues.c_str() << std::endl;
+		std::cout << "MobiFlight: NewClient DataAreaNameTriggers: " << newClient->DataAreaNameTriggers.c_str() << std::endl;
 		std::cout << "MobiFlight: NewClient DataDefinitionIDStringResponse: " << newClient->DataDefinitionIDStringResponse << std::endl;
 		std::cout << "MobiFlight: NewClient DataDefinitionIDStringCommand: " << newClient->DataDefinitionIDStringCommand << std::endl;
+		std::cout << "MobiFlight: NewClient DataDefinitionIDWriteValues: " << newClient->DataDefinitionIDWriteValues << std::endl;
+		std::cout << "MobiFlight: NewClient DataDefinitionIDTriggers: " << newClient->DataDefinitionIDTriggers << std::endl;
 		std::cout << "MobiFlight: NewClient DataDefinitionIdSimVarsStart: " << newClient->DataDefinitionIdSimVarsStart << std::endl;
 		std::cout << "MobiFlight: NewClient DataDefinitionIdStringVarsStart: " << newClient->DataDefinitionIdStringVarsStart << std::endl;
 #endif
@@ -640,6 +1294,19 @@ void CALLBACK MyDispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContex
 
 		case SIMCONNECT_RECV_ID_CLIENT_DATA: {
 			auto recv_data = static_cast<SIMCONNECT_RECV_CLIENT_DATA*>(pData);
+
+			if (recv_data->dwRequestID >= CLIENT_DATA_REQUEST_ID_TRIGGERS_OFFSET) {
+				DWORD triggersClientID = (DWORD)recv_data->dwRequestID - CLIENT_DATA_REQUEST_ID_TRIGGERS_OFFSET;
+				ReceiveTriggers(recv_data, RegisteredClients[triggersClientID]);
+				break;
+			}
+
+			if (recv_data->dwRequestID >= CLIENT_DATA_REQUEST_ID_WRITEVALUES_OFFSET) {
+				DWORD writeValuesClientID = (DWORD)recv_data->dwRequestID - CLIENT_DATA_REQUEST_ID_WRITEVALUES_OFFSET;
+				ReceiveWriteValues(recv_data, RegisteredClients[writeValuesClientID]);
+				break;
+			}
+
 			std::string str = std::string((char*)(&recv_data->dwData));
 			DWORD clientID = (DWORD)recv_data->dwRequestID;
 #if _DEBUG
@@ -683,9 +1350,30 @@ void CALLBACK MyDispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContex
 				execute_calculator_code(str.c_str(), 0, nullptr, nullptr);
 				break;
 			}
+			else if (str == "MF.WriteValues.Clear") {
+				ClearWriteValues(client);
+				break;
+			}
+			// MF.WriteValues.Bind.0.(>L:MyVar)
+			else if (str.find("MF.WriteValues.Bind.") != std::string::npos) {
+				std::string prefix = "MF.WriteValues.Bind.";
+				str = str.substr(prefix.length());
+				BindWriteValue(str, client);
+				std::cout << "MobiFlight[" << client->Name.c_str() << "]: Received WriteValue to bind: " << str.c_str() << std::endl;
+				break;
+			}
+			else if (str == "MF.SimVars.Manifest.Get") {
+				SendManifest(client);
+				break;
+			}
 
 			std::shared_ptr<std::string> m_str = std::make_shared<std::string>(str);
 
+			// All MF.SimVars.Add* commands are part of the manifest
+			if (m_str.get()->rfind("MF.SimVars.Add", 0) == 0) {
+				AddRegistration(*m_str.get(), client);
+			}
+
 			if (m_str.get()->find("MF.SimVars.Add.") != std::string::npos) {
 				std::string prefix = "MF.SimVars.Add.";
 				str = m_str.get()->substr(prefix.length());
@@ -702,6 +1390,42 @@ void CALLBACK MyDispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContex
 				break;
 			}
 
+			// MF.SimVars.AddDerived.0.Ema.2.5
+			if (m_str.get()->find("MF.SimVars.AddDerived.") != std::string::npos) {
+				std::string prefix = "MF.SimVars.AddDerived.";
+				str = m_str.get()->substr(prefix.length());
+				RegisterDerivedSimVar(str, client);
+				std::cout << "MobiFlight[" << client->Name.c_str() << "]: Received derived SimVar to register: " << str.c_str() << std::endl;
+				break;
+			}
+
+			// MF.SimVars.AddGroup.MyGroup.(L:MyGate)
+			if (m_str.get()->find("MF.SimVars.AddGroup.") != std::string::npos) {
+				std::string prefix = "MF.SimVars.AddGroup.";
+				str = m_str.get()->substr(prefix.length());
+				RegisterSimVarGroup(str, client);
+				std::cout << "MobiFlight[" << client->Name.c_str() << "]: Received SimVarGroup to register: " << str.c_str() << std::endl;
+				break;
+			}
+
+			// MF.SimVars.AddToGroup.MyGroup.(L:MyVar)
+			if (m_str.get()->find("MF.SimVars.AddToGroup.") != std::string::npos) {
+				std::string prefix = "MF.SimVars.AddToGroup.";
+				str = m_str.get()->substr(prefix.length());
+				RegisterGroupSimVar(str, client, false);
+				std::cout << "MobiFlight[" << client->Name.c_str() << "]: Received SimVar to register in group: " << str.c_str() << std::endl;
+				break;
+			}
+
+			// MF.SimVars.AddStringToGroup.MyGroup.(A:GPS WP NEXT ID,String)
+			if (m_str.get()->find("MF.SimVars.AddStringToGroup.") != std::string::npos) {
+				std::string prefix = "MF.SimVars.AddStringToGroup.";
+				str = m_str.get()->substr(prefix.length());
+				RegisterGroupSimVar(str, client, true);
+				std::cout << "MobiFlight[" << client->Name.c_str() << "]: Received StringSimVar to register in group: " << str.c_str() << std::endl;
+				break;
+			}
+
 			if (m_str.get()->find("MF.Clients.Add.") != std::string::npos) {
 				std::string prefix = "MF.Clients.Add.";
 				str= m_str.get()->substr(prefix.length());
@@ -717,11 +1441,26 @@ void CALLBACK MyDispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContex
 				MOBIFLIGHT_MAX_VARS_PER_FRAME = value;
 				std::cout << "MobiFlight: Set MF.Config.MAX_VARS_PER_FRAME to " << value << std::endl;
 			}
+
+			if (m_str.get()->find("MF.Config.GROUP_GATE_INTERVAL.Set.") != std::string::npos) {
+				std::string prefix = "MF.Config.GROUP_GATE_INTERVAL.Set.";
+				str = m_str.get()->substr(prefix.length());
+				char* end = nullptr;
+				long value = strtol(str.c_str(), &end, 10);
+				if (str.empty() || *end != '\0' || value < 1 || value > UINT16_MAX) {
+					fprintf(stderr, "MobiFlight: Invalid MF.Config.GROUP_GATE_INTERVAL \"%s\"\n", str.c_str());
+					break;
+				}
+				MOBIFLIGHT_GROUP_GATE_INTERVAL = static_cast<uint16_t>(value);
+				std::cout << "MobiFlight: Set MF.Config.GROUP_GATE_INTERVAL to " << value << std::endl;
+			}
 			break;
 		}
 
 		case SIMCONNECT_RECV_ID_EVENT_FRAME: {
 			SIMCONNECT_RECV_EVENT* evt = (SIMCONNECT_RECV_EVENT*)pData;
+			ApplyWriteValues();
+			ExecuteTriggers();
 			ReadSimVars();
 			break;
 		}